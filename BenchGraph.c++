@@ -0,0 +1,456 @@
+// -----------------------------
+// projects/graph/BenchGraph.c++
+// -----------------------------
+
+/*
+To run the benchmark:
+    % g++ -ansi -pedantic -O2 -I/public/linux/include/boost-1_44 -Wall BenchGraph.c++ -o BenchGraph.app
+    % BenchGraph.app           > BenchGraph.out
+    % BenchGraph.app 10000000  > BenchGraph.out
+
+The optional argument is the largest edge count to generate (default
+1000000); sizes run in powers of ten from 1000 up to it. Every operation
+the TestGraph fixtures exercise is timed against both
+adjacency_list<setS, vecS, directedS> and Graph on the same input, so a
+Graph regression shows up next to the Boost row it is meant to match.
+
+Columns:
+    graph  shape  edges  operation  ns/op  allocs/op  bytes/edge
+bytes/edge is only reported for "add_edge" and is the live heap owned by
+the graph after loading, divided by num_edges.
+*/
+
+// --------
+// includes
+// --------
+
+#include <algorithm> // max, min, sort, swap, unique
+#include <cstdio>    // printf
+#include <cstdlib>   // malloc, free, strtoul
+#include <ctime>     // clock, CLOCKS_PER_SEC
+#include <iterator>  // back_inserter
+#include <new>       // bad_alloc
+#include <utility>   // make_pair, pair
+#include <vector>    // vector
+
+// Boost's edge iterator trips GCC's -Wmaybe-uninitialized inside its own
+// headers; that is not this file's to fix.
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#include "boost/graph/adjacency_list.hpp"   // adjacency_list
+#include "boost/graph/topological_sort.hpp" // topological_sort
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+
+#include "Graph.h"
+
+using namespace std;
+
+// ----------------
+// allocation count
+// ----------------
+
+/*
+Every allocation carries a small header holding its size, so the live
+byte count stays exact across new and delete.
+*/
+
+namespace {
+    const size_t header_size = 16;
+
+    unsigned long alloc_count = 0;
+    unsigned long alloc_live  = 0;
+
+    // keeps iteration loops from being optimized away
+    volatile unsigned long sink = 0;
+}
+
+// Kept out of line: once inlined, GCC pairs the malloc and the free across
+// the size header and reports bogus mismatched-new-delete/array-bounds.
+#ifdef __GNUC__
+#define BENCH_NOINLINE __attribute__ ((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+#if __cplusplus >= 201103L
+#define BENCH_THROW_BAD_ALLOC
+#define BENCH_NOTHROW noexcept
+#else
+#define BENCH_THROW_BAD_ALLOC throw (std::bad_alloc)
+#define BENCH_NOTHROW         throw ()
+#endif
+
+BENCH_NOINLINE void* operator new (size_t s) BENCH_THROW_BAD_ALLOC {
+    char* p = static_cast<char*>(malloc(s + header_size));
+    if (!p)
+        throw bad_alloc();
+    *reinterpret_cast<size_t*>(p) = s;
+    ++alloc_count;
+    alloc_live += s;
+    return p + header_size;
+}
+
+BENCH_NOINLINE void operator delete (void* v) BENCH_NOTHROW {
+    if (!v)
+        return;
+    char* p = static_cast<char*>(v) - header_size;
+    alloc_live -= *reinterpret_cast<size_t*>(p);
+    free(p);
+}
+
+BENCH_NOINLINE void* operator new[] (size_t s) BENCH_THROW_BAD_ALLOC {
+    return operator new(s);
+}
+
+BENCH_NOINLINE void operator delete[] (void* v) BENCH_NOTHROW {
+    operator delete(v);
+}
+
+#ifdef __cpp_sized_deallocation
+BENCH_NOINLINE void operator delete (void* v, size_t) BENCH_NOTHROW {
+    operator delete(v);
+}
+
+BENCH_NOINLINE void operator delete[] (void* v, size_t) BENCH_NOTHROW {
+    operator delete(v);
+}
+#endif
+
+// ---------
+// edge_list
+// ---------
+
+typedef pair<unsigned long, unsigned long> edge_pair;
+typedef vector<edge_pair>                  edge_list;
+
+/*
+Deterministic generator so every run, and both graph types, see the same
+edges.
+*/
+struct Random {
+    unsigned long _s;
+
+    explicit Random (unsigned long s) :
+            _s (s)
+        {}
+
+    // the low bits of a power-of-two LCG have short periods, so only the
+    // high 16 bits of each step are used
+    unsigned long next () {
+        _s = (_s * 1103515245UL + 12345UL) & 0xffffffffUL;
+        return _s >> 16;
+    }
+
+    unsigned long operator () (unsigned long n) {
+        if (n <= 65536UL)
+            return next() % n;
+        const unsigned long hi = next();
+        return (hi * 65536UL + next()) % n;
+    }
+};
+
+void normalize (edge_list& el) {
+    sort(el.begin(), el.end());
+    el.erase(unique(el.begin(), el.end()), el.end());
+}
+
+/*
+All shapes are DAGs (edges run from a lower to a higher vertex, or the
+reverse for power_law) so topological_sort measures a full traversal
+rather than an early not_a_dag.
+*/
+
+unsigned long make_chain (unsigned long ne, edge_list& el) {
+    for (unsigned long i = 0; i != ne; ++i)
+        el.push_back(make_pair(i, i + 1));
+    return ne + 1;
+}
+
+unsigned long make_random (unsigned long ne, edge_list& el) {
+    const unsigned long nv = max(ne / 8, 16UL);
+    Random r(ne);
+    while (el.size() < ne) {
+        for (unsigned long i = el.size(); i != ne; ++i) {
+            unsigned long u = r(nv);
+            unsigned long v = r(nv);
+            if (u == v)
+                continue;
+            if (v < u)
+                swap(u, v);
+            el.push_back(make_pair(u, v));
+        }
+        normalize(el);
+    }
+    return nv;
+}
+
+unsigned long make_layered (unsigned long ne, edge_list& el) {
+    const unsigned long degree = 4;
+    const unsigned long nv     = max(ne / degree, 16UL);
+    unsigned long width = 1;
+    while (width * width < nv)
+        ++width;
+    Random r(ne + 1);
+    for (unsigned long u = 0; (u + width < nv) && (el.size() < ne); ++u) {
+        const unsigned long next = (u / width + 1) * width;
+        const unsigned long span = min(width, nv - next);
+        for (unsigned long k = 0; k != degree; ++k)
+            el.push_back(make_pair(u, next + r(span)));
+    }
+    normalize(el);
+    return nv;
+}
+
+unsigned long make_power_law (unsigned long ne, edge_list& el) {
+    // preferential attachment: each new vertex points at m older ones,
+    // chosen in proportion to their degree
+    const unsigned long m  = 4;
+    const unsigned long nv = max(ne / m, m + 1);
+    vector<unsigned long> pool;
+    Random r(ne + 2);
+    for (unsigned long v = 1; v <= m; ++v) {
+        el.push_back(make_pair(v, 0UL));
+        pool.push_back(0);
+        pool.push_back(v);
+    }
+    for (unsigned long v = m + 1; v != nv; ++v) {
+        // v joins the pool only after its own edges, so no self-loops
+        const unsigned long n = pool.size();
+        for (unsigned long k = 0; k != m; ++k) {
+            const unsigned long t = pool[r(n)];
+            el.push_back(make_pair(v, t));
+            pool.push_back(t);
+        }
+        for (unsigned long k = 0; k != m; ++k)
+            pool.push_back(v);
+    }
+    normalize(el);
+    return nv;
+}
+
+// ----------
+// BenchGraph
+// ----------
+
+template <typename T>
+struct BenchGraph {
+    // --------
+    // typedefs
+    // --------
+
+    typedef T                                       graph_type;
+
+    typedef typename graph_type::vertex_descriptor  vertex_descriptor;
+    typedef typename graph_type::edge_descriptor    edge_descriptor;
+
+    typedef typename graph_type::vertex_iterator    vertex_iterator;
+    typedef typename graph_type::edge_iterator      edge_iterator;
+    typedef typename graph_type::adjacency_iterator adjacency_iterator;
+
+    typedef typename graph_type::vertices_size_type vertices_size_type;
+    typedef typename graph_type::edges_size_type    edges_size_type;
+
+    // -----
+    // state
+    // -----
+
+    const char*      _name;
+    const char*      _shape;
+    const edge_list& _el;
+    unsigned long    _nv;
+    unsigned long    _reps;
+
+    clock_t          _t0;
+    unsigned long    _a0;
+
+    BenchGraph (const char* name, const char* shape, const edge_list& el, unsigned long nv) :
+            _name  (name),
+            _shape (shape),
+            _el    (el),
+            _nv    (nv),
+            _reps  (max(1000000 / max(el.size(), 1UL), 1UL))
+        {}
+
+    // -------
+    // helpers
+    // -------
+
+    void start () {
+        _a0 = alloc_count;
+        _t0 = clock();
+    }
+
+    void stop (const char* op, unsigned long ops, double bytes_per_edge = -1) {
+        const clock_t t = clock() - _t0;
+        const unsigned long a = alloc_count - _a0;
+        if (ops == 0)
+            ops = 1;
+        printf("%-8s %-10s %9lu %-18s %12.1f %10.3f",
+               _name, _shape, static_cast<unsigned long>(_el.size()), op,
+               1e9 * t / CLOCKS_PER_SEC / ops,
+               static_cast<double>(a) / ops);
+        if (bytes_per_edge >= 0)
+            printf(" %10.1f", bytes_per_edge);
+        printf("\n");
+    }
+
+    // ----------
+    // operations
+    // ----------
+
+    void bench_add_vertex () {
+        start();
+        for (unsigned long r = 0; r != _reps; ++r) {
+            graph_type g;
+            for (unsigned long i = 0; i != _nv; ++i)
+                add_vertex(g);
+        }
+        stop("add_vertex", _reps * _nv);
+    }
+
+    void bench_add_edge (graph_type& g) {
+        for (unsigned long i = 0; i != _nv; ++i)
+            add_vertex(g);
+        const unsigned long live = alloc_live;
+        start();
+        for (edge_list::const_iterator b = _el.begin(); b != _el.end(); ++b)
+            add_edge(b->first, b->second, g);
+        const double bytes = static_cast<double>(alloc_live - live) / max(num_edges(g), edges_size_type(1));
+        stop("add_edge", _el.size(), bytes);
+    }
+
+    void bench_add_edge_dup (graph_type& g) {
+        unsigned long n = 0;
+        start();
+        for (unsigned long r = 0; r != _reps; ++r)
+            for (edge_list::const_iterator b = _el.begin(); b != _el.end(); ++b)
+                n += !add_edge(b->first, b->second, g).second;
+        stop("add_edge_dup", n);
+    }
+
+    void bench_edge_hit (const graph_type& g) {
+        unsigned long n = 0;
+        start();
+        for (unsigned long r = 0; r != _reps; ++r)
+            for (edge_list::const_iterator b = _el.begin(); b != _el.end(); ++b)
+                n += edge(b->first, b->second, g).second;
+        stop("edge_hit", n);
+    }
+
+    void bench_edge_miss (const graph_type& g) {
+        unsigned long n = 0;
+        start();
+        for (unsigned long r = 0; r != _reps; ++r)
+            for (edge_list::const_iterator b = _el.begin(); b != _el.end(); ++b)
+                n += !edge(b->second, b->first, g).second;
+        stop("edge_miss", n);
+    }
+
+    void bench_adjacent_vertices (const graph_type& g) {
+        unsigned long n = 0;
+        start();
+        for (unsigned long r = 0; r != _reps; ++r) {
+            pair<vertex_iterator, vertex_iterator> v = vertices(g);
+            for (; v.first != v.second; ++v.first) {
+                pair<adjacency_iterator, adjacency_iterator> p = adjacent_vertices(*v.first, g);
+                for (; p.first != p.second; ++p.first, ++n)
+                    sink += *p.first;
+            }
+        }
+        stop("adjacent_vertices", n);
+    }
+
+    void bench_edges (const graph_type& g) {
+        unsigned long n = 0;
+        start();
+        for (unsigned long r = 0; r != _reps; ++r) {
+            pair<edge_iterator, edge_iterator> p = edges(g);
+            for (; p.first != p.second; ++p.first, ++n)
+                sink += target(*p.first, g);
+        }
+        stop("edges", n);
+    }
+
+    void bench_copy (const graph_type& g) {
+        start();
+        for (unsigned long r = 0; r != _reps; ++r) {
+            graph_type g2 = g;
+            if (num_edges(g2) != num_edges(g))
+                printf("copy mismatch\n");
+        }
+        stop("copy", _reps);
+    }
+
+    void bench_has_cycle (const graph_type& g) {
+        unsigned long n = 0;
+        start();
+        for (unsigned long r = 0; r != _reps; ++r)
+            n += has_cycle(g);
+        stop("has_cycle", _reps);
+        if (n != 0)
+            printf("unexpected cycle\n");
+    }
+
+    void bench_topological_sort (const graph_type& g) {
+        vector<vertex_descriptor> out;
+        out.reserve(num_vertices(g));
+        start();
+        for (unsigned long r = 0; r != _reps; ++r) {
+            out.clear();
+            topological_sort(g, back_inserter(out));
+        }
+        stop("topological_sort", _reps);
+    }
+
+    // ---
+    // run
+    // ---
+
+    void run () {
+        bench_add_vertex();
+        graph_type g;
+        bench_add_edge(g);
+        bench_add_edge_dup(g);
+        bench_edge_hit(g);
+        bench_edge_miss(g);
+        bench_adjacent_vertices(g);
+        bench_edges(g);
+        bench_copy(g);
+        bench_has_cycle(g);
+        bench_topological_sort(g);
+    }
+};
+
+// ----
+// main
+// ----
+
+int main (int argc, char* argv[]) {
+    using namespace boost;
+
+    printf("BenchGraph.c++\n");
+
+    const unsigned long max_edges = (argc > 1) ? strtoul(argv[1], 0, 10) : 1000000;
+
+    typedef unsigned long (*generator) (unsigned long, edge_list&);
+    const char* const shapes[]     = {"chain", "random", "layered", "power_law"};
+    const generator   generators[] = {make_chain, make_random, make_layered, make_power_law};
+
+    printf("%-8s %-10s %9s %-18s %12s %10s %10s\n",
+           "graph", "shape", "edges", "operation", "ns/op", "allocs/op", "bytes/edge");
+    for (unsigned long ne = 1000; ne <= max_edges; ne *= 10)
+        for (int i = 0; i != 4; ++i) {
+            edge_list el;
+            el.reserve(ne);
+            const unsigned long nv = generators[i](ne, el);
+            BenchGraph< adjacency_list<setS, vecS, directedS> >("boost", shapes[i], el, nv).run();
+            BenchGraph<Graph>                                   ("Graph", shapes[i], el, nv).run();
+        }
+
+    printf("Done.\n");
+    return 0;
+}
@@ -1204,6 +1204,95 @@ struct TestGraph : CppUnit::TestFixture {
 		CPPUNIT_ASSERT(has_cycle(g));
 	}
 
+	void test_has_cycle_9() {
+		// test_has_cycle_1, checked after every edge: only edFD closes a cycle.
+		graph_type g;
+
+		vd vdA = add_vertex(g);
+		vd vdB = add_vertex(g);
+		vd vdC = add_vertex(g);
+		vd vdD = add_vertex(g);
+		vd vdE = add_vertex(g);
+		vd vdF = add_vertex(g);
+		add_vertex(g);
+		vd vdH = add_vertex(g);
+
+		add_edge(vdA, vdB, g);
+		CPPUNIT_ASSERT(!has_cycle(g));
+		add_edge(vdA, vdC, g);
+		CPPUNIT_ASSERT(!has_cycle(g));
+		add_edge(vdA, vdE, g);
+		CPPUNIT_ASSERT(!has_cycle(g));
+		add_edge(vdB, vdD, g);
+		CPPUNIT_ASSERT(!has_cycle(g));
+		add_edge(vdB, vdE, g);
+		CPPUNIT_ASSERT(!has_cycle(g));
+		add_edge(vdC, vdD, g);
+		CPPUNIT_ASSERT(!has_cycle(g));
+		add_edge(vdD, vdE, g);
+		CPPUNIT_ASSERT(!has_cycle(g));
+		add_edge(vdD, vdF, g);
+		CPPUNIT_ASSERT(!has_cycle(g));
+		add_edge(vdF, vdH, g);
+		CPPUNIT_ASSERT(!has_cycle(g));
+
+		add_edge(vdF, vdD, g);
+		CPPUNIT_ASSERT(has_cycle(g));
+	}
+
+	void test_has_cycle_10() {
+		// Random edge streams kept acyclic: each candidate edge is tried on a
+		// copy, has_cycle must agree with a full topological_sort there, and
+		// the edge is kept only if it leaves the graph a DAG.
+		const vertices_size_type s = 64;
+		const unsigned long seeds[] = {378, 2012, 65537};
+
+		for (int n = 0; n < 3; ++n) {
+			graph_type g;
+
+			for (vertices_size_type i = 0; i < s; ++i)
+				add_vertex(g);
+
+			unsigned long seed = seeds[n];
+			int kept = 0;
+			int rejected = 0;
+			for (int k = 0; k < 1000; ++k) {
+				seed = (seed * 1103515245UL + 12345UL) & 0xffffffffUL;
+				vd u = (seed >> 16) % s;
+				seed = (seed * 1103515245UL + 12345UL) & 0xffffffffUL;
+				vd v = (seed >> 16) % s;
+				if (u == v)
+					continue;
+
+				graph_type g2 = g;
+				add_edge(u, v, g2);
+
+				bool sort_failed = false;
+				try {
+					ostringstream out;
+					topological_sort(g2, ostream_iterator<vertex_descriptor>(out, " "));
+				} catch (not_a_dag& e) {
+					sort_failed = true;
+				} catch (boost::not_a_dag& e) {
+					sort_failed = true;
+				}
+
+				CPPUNIT_ASSERT(has_cycle(g2) == sort_failed);
+				if (sort_failed)
+					++rejected;
+				else {
+					add_edge(u, v, g);
+					++kept;
+				}
+				CPPUNIT_ASSERT(!has_cycle(g));
+			}
+
+			// both the acyclic and the cycle-closing cases were exercised
+			CPPUNIT_ASSERT(kept > 100);
+			CPPUNIT_ASSERT(rejected > 100);
+		}
+	}
+
     // ---------------------
     // test_topological_sort
     // ---------------------
@@ -1402,6 +1491,86 @@ struct TestGraph : CppUnit::TestFixture {
 		CPPUNIT_ASSERT(my_output.str() == boost_output);
 	}
 
+	void test_stress_4() {
+		// A 10^6 chain overflows a recursive DFS on a default 8 MB stack.
+		graph_type g;
+
+		const vertices_size_type s = 1000000;
+
+		for (vertices_size_type i = 0; i < s; ++i)
+			add_vertex(g);
+
+		for (vertices_size_type i = 0; i < s - 1; ++i)
+			add_edge(i, i + 1, g);
+
+		ostringstream my_output;
+		topological_sort(g, ostream_iterator<vertex_descriptor>(my_output, " "));
+
+		ostringstream boost_output;
+		for (vertices_size_type i = s; i > 0; --i)
+			boost_output << (i - 1) << " ";
+
+		CPPUNIT_ASSERT(!has_cycle(g));
+		CPPUNIT_ASSERT(my_output.str() == boost_output.str());
+	}
+
+	void test_stress_5() {
+		graph_type g;
+
+		const vertices_size_type s = 1000000;
+
+		for (vertices_size_type i = 0; i < s; ++i)
+			add_vertex(g);
+
+		for (vertices_size_type i = 0; i < s - 1; ++i)
+			add_edge(i, i + 1, g);
+
+		// Close the chain into a single long cycle.
+		add_edge(s - 1, 0, g);
+
+		CPPUNIT_ASSERT(has_cycle(g));
+
+		try {
+			ostringstream out;
+			topological_sort(g, ostream_iterator<vertex_descriptor>(out, " "));
+			CPPUNIT_ASSERT(false);
+		} catch (not_a_dag& e) {
+			CPPUNIT_ASSERT(strcmp(e.what(), "The graph must be a DAG.") == 0);
+		} catch (boost::not_a_dag& e) {
+			CPPUNIT_ASSERT(strcmp(e.what(), "The graph must be a DAG.") == 0);
+		}
+	}
+
+	void test_stress_6() {
+		// test_stress_2 scaled up; every repeated sort must give Boost's order.
+		graph_type g;
+
+		const vertices_size_type s = 1000000;
+
+		for (vertices_size_type i = 0; i < s; ++i)
+			add_vertex(g);
+
+		for (vertices_size_type i = 0; i < s - 2; ++i)
+			add_edge(i, i + 2, g);
+
+		for (vertices_size_type i = 2; i < s; i += 2)
+			add_edge(i, i - 1, g);
+
+		// odd vertices descending, then even vertices descending
+		ostringstream boost_output;
+		for (vertices_size_type i = s; i > 0; i -= 2)
+			boost_output << (i - 1) << " ";
+		for (vertices_size_type i = s; i > 0; i -= 2)
+			boost_output << (i - 2) << " ";
+
+		for (int k = 0; k < 3; ++k) {
+			ostringstream my_output;
+			topological_sort(g, ostream_iterator<vertex_descriptor>(my_output, " "));
+			CPPUNIT_ASSERT(my_output.str() == boost_output.str());
+			CPPUNIT_ASSERT(!has_cycle(g));
+		}
+	}
+
     // -----
     // suite
     // -----
@@ -1459,6 +1628,8 @@ struct TestGraph : CppUnit::TestFixture {
     CPPUNIT_TEST(test_has_cycle_6);
     CPPUNIT_TEST(test_has_cycle_7);
     CPPUNIT_TEST(test_has_cycle_8);
+    CPPUNIT_TEST(test_has_cycle_9);
+    CPPUNIT_TEST(test_has_cycle_10);
     CPPUNIT_TEST(test_topological_sort_1);
     CPPUNIT_TEST(test_topological_sort_2);
     CPPUNIT_TEST(test_topological_sort_3);
@@ -1469,6 +1640,9 @@ struct TestGraph : CppUnit::TestFixture {
     CPPUNIT_TEST(test_stress_1);
     CPPUNIT_TEST(test_stress_2);
     CPPUNIT_TEST(test_stress_3);
+    CPPUNIT_TEST(test_stress_4);
+    CPPUNIT_TEST(test_stress_5);
+    CPPUNIT_TEST(test_stress_6);
     CPPUNIT_TEST_SUITE_END();
 };
 